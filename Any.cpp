@@ -1,5 +1,11 @@
 #include "Any.h"
 
+#include <algorithm> // std::sort, std::stable_sort, std::inplace_merge, std::unique, std::binary_search
+#include <cmath> // std::isnan
+#include <cstring> // std::strlen, memcpy
+#include <system_error> // std::system_error
+#include <thread> // Any::Array::parallel_sort
+
 ////////////////////////////////////////////////////////////////////////////////
 // Public implementation
 
@@ -10,7 +16,8 @@ const char* const Any::TypeNames[(unsigned)Any::Type::COUNT] = {
 	"Double",
 	"String",
 	"Group",
-	"Invalid"
+	"Invalid",
+	"StringView"
 };
 
 // Initialize to an invalid type so that very little work needs to be done
@@ -22,12 +29,14 @@ Any::Any()
 	, mWholeNumber(*this, mData.mWholeNumber, &Any::_getWholeNumber, &Any::_setWholeNumber)
 	, mDecimalNumber(*this, mData.mDecimalNumber, &Any::_getDecimalNumber, &Any::_setDecimalNumber)
 	, mTextString(*this, mData.mTextString, &Any::_getTextString, &Any::_setTextString)
+	, mTextStringView(*this, mData.mTextStringView, &Any::_getTextStringView, &Any::_setTextStringView)
 	, mArrayGroup(*this, mData.mArrayGroup, &Any::_getObjectGroup, &Any::_setObjectGroup)
 	, mInternalType(Type::INVALID_UNSET)
 	, mInternalTypeName(TypeNames[(unsigned)Type::INVALID_UNSET])
 	, mInternalWholeNumber(mData.mWholeNumber)
 	, mInternalDecimalNumber(mData.mDecimalNumber)
 	, mInternalTextString(mData.mTextString)
+	, mInternalTextStringView(mData.mTextStringView)
 	, mInternalArrayGroup(mData.mArrayGroup)
 {
 }
@@ -85,12 +94,11 @@ Any::Any(DECIMAL_NUMBER_TYPE value)
 	mInternalDecimalNumber = value;
 }
 
-// Do minimal work to get a valid Any object, then initialize with a valid value
-// TODO: Investigate performance optimization
+// Do minimal work to get a valid Any object, then take over the value's buffer
 Any::Any(TEXT_STRING_TYPE value)
 	: Any(Type::TEXT_STRING)
 {
-	mInternalTextString = value;
+	mInternalTextString = std::move(value);
 }
 
 Any::Any(const char* const value)
@@ -98,17 +106,26 @@ Any::Any(const char* const value)
 {
 }
 
+// Copy the characters straight into the value without a temporary string
+// Short strings stay inside the string object itself (no heap allocation)
 Any::Any(const char* const value, unsigned length)
-	: Any(TEXT_STRING_TYPE(value, length))
+	: Any(Type::TEXT_STRING)
 {
+	mInternalTextString.assign(value, length);
 }
 
-// Do minimal work to get a valid Any object, then initialize with a valid value
-// TODO: Investigate performance optimization
+// Only the reference is stored, so no characters are copied
+Any::Any(TEXT_STRING_VIEW_TYPE value)
+	: Any(Type::TEXT_STRING_VIEW)
+{
+	mInternalTextStringView = value;
+}
+
+// Do minimal work to get a valid Any object, then take over the value's elements
 Any::Any(Any::Array value)
 	: Any(Type::ARRAY_GROUP)
 {
-	mInternalArrayGroup = value;
+	mInternalArrayGroup = std::move(value);
 }
 
 // Destroy the value and clear the type
@@ -137,6 +154,53 @@ Any Any::pop_back()
 	return mInternalArrayGroup.pop_back();
 }
 
+// Build the owned string before the view is replaced, since they share memory
+void Any::own()
+{
+	if (mInternalType == Type::TEXT_STRING_VIEW)
+	{
+		TEXT_STRING_TYPE owned(mInternalTextStringView);
+		_setType(Type::TEXT_STRING);
+		mInternalTextString = std::move(owned);
+	}
+}
+
+void Any::sort()
+{
+	_setType(Type::ARRAY_GROUP);
+	mInternalArrayGroup.sort();
+}
+
+void Any::stable_sort()
+{
+	_setType(Type::ARRAY_GROUP);
+	mInternalArrayGroup.stable_sort();
+}
+
+void Any::parallel_sort()
+{
+	_setType(Type::ARRAY_GROUP);
+	mInternalArrayGroup.parallel_sort();
+}
+
+void Any::unique()
+{
+	_setType(Type::ARRAY_GROUP);
+	mInternalArrayGroup.unique();
+}
+
+bool Any::binary_search(const Any& any)
+{
+	_setType(Type::ARRAY_GROUP);
+	return mInternalArrayGroup.binary_search(any);
+}
+
+Any Any::group_by()
+{
+	_setType(Type::ARRAY_GROUP);
+	return mInternalArrayGroup.group_by();
+}
+
 Any::Array::Iterator Any::begin()
 {
 	_setType(Type::ARRAY_GROUP);
@@ -149,6 +213,22 @@ Any::Array::Iterator Any::end()
 	return mInternalArrayGroup.end();
 }
 
+// Comparison never changes the types of the objects being compared
+bool operator==(const Any& left, const Any& right)
+{
+	return Any::_compare(left, right) == 0;
+}
+
+bool operator!=(const Any& left, const Any& right)
+{
+	return Any::_compare(left, right) != 0;
+}
+
+bool operator<(const Any& left, const Any& right)
+{
+	return Any::_compare(left, right) < 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Private implementation
 
@@ -215,6 +295,10 @@ void Any::_init()
 		// Obtain the string of text with placement new
 		new (&mInternalTextString) std::string();
 		break;
+	case Type::TEXT_STRING_VIEW:
+		// Start out referencing nothing
+		new (&mInternalTextStringView) TEXT_STRING_VIEW_TYPE();
+		break;
 	case Type::ARRAY_GROUP:
 		// Obtain all contained objects with placement new
 		new (&mInternalArrayGroup) Array();
@@ -240,6 +324,10 @@ void Any::_copyValue(const Any& other)
 	case Any::Type::TEXT_STRING:
 		mInternalTextString = other.mInternalTextString;
 		break;
+	case Any::Type::TEXT_STRING_VIEW:
+		// Both objects reference the same characters
+		mInternalTextStringView = other.mInternalTextStringView;
+		break;
 	case Any::Type::ARRAY_GROUP:
 		mInternalArrayGroup = other.mInternalArrayGroup;
 		break;
@@ -256,6 +344,70 @@ void Any::_swapContents(Any&& other)
 	std::swap(mData, other.mData);
 }
 
+// Order by type first, then by value within the type
+// Strings and views are the same kind of value, so they compare by their characters
+// Not-a-number orders after every other decimal so sorting stays well defined
+// Groups order like words: element by element, then shorter first
+int Any::_compare(const Any& left, const Any& right)
+{
+	Type leftType = _sortType(left.mInternalType);
+	Type rightType = _sortType(right.mInternalType);
+	if (leftType != rightType)
+	{
+		return leftType < rightType ? -1 : 1;
+	}
+	switch (leftType)
+	{
+	case Type::WHOLE_NUMBER:
+		return (left.mInternalWholeNumber > right.mInternalWholeNumber)
+			- (left.mInternalWholeNumber < right.mInternalWholeNumber);
+	case Type::DECIMAL_NUMBER:
+	{
+		bool leftNan = std::isnan(left.mInternalDecimalNumber);
+		bool rightNan = std::isnan(right.mInternalDecimalNumber);
+		if (leftNan || rightNan)
+		{
+			return static_cast<int>(leftNan) - static_cast<int>(rightNan);
+		}
+		return (left.mInternalDecimalNumber > right.mInternalDecimalNumber)
+			- (left.mInternalDecimalNumber < right.mInternalDecimalNumber);
+	}
+	case Type::TEXT_STRING:
+	{
+		int result = left._textContent().compare(right._textContent());
+		return (result > 0) - (result < 0);
+	}
+	case Type::ARRAY_GROUP:
+	{
+		const std::vector<Any>& leftGroup = left.mInternalArrayGroup.mGroup;
+		const std::vector<Any>& rightGroup = right.mInternalArrayGroup.mGroup;
+		size_t count = leftGroup.size() < rightGroup.size() ? leftGroup.size() : rightGroup.size();
+		for (size_t i = 0; i < count; ++i)
+		{
+			int result = _compare(leftGroup[i], rightGroup[i]);
+			if (result != 0)
+			{
+				return result;
+			}
+		}
+		return (leftGroup.size() > rightGroup.size()) - (leftGroup.size() < rightGroup.size());
+	}
+	default:
+		// All invalid objects are equivalent
+		return 0;
+	}
+}
+
+Any::Type Any::_sortType(Type type)
+{
+	return type == Type::TEXT_STRING_VIEW ? Type::TEXT_STRING : type;
+}
+
+TEXT_STRING_VIEW_TYPE Any::_textContent() const
+{
+	return mInternalType == Type::TEXT_STRING_VIEW ? mInternalTextStringView : TEXT_STRING_VIEW_TYPE(mInternalTextString);
+}
+
 Any::Array::Iterator::Iterator()
 	: mAny(nullptr)
 {
@@ -318,6 +470,29 @@ Any::Array::Array()
 {
 }
 
+Any::Array::Array(const Array& other)
+	: mGroup(other.mGroup)
+{
+}
+
+Any::Array& Any::Array::operator=(const Array& other)
+{
+	mGroup = other.mGroup;
+	return *this;
+}
+
+// Take over the other's elements without copying them
+Any::Array::Array(Array&& other)
+	: mGroup(std::move(other.mGroup))
+{
+}
+
+Any::Array& Any::Array::operator=(Array&& other)
+{
+	mGroup = std::move(other.mGroup);
+	return *this;
+}
+
 Any::Array::~Array()
 {
 }
@@ -341,6 +516,63 @@ Any Any::Array::pop_back()
 	return back;
 }
 
+unsigned Any::Array::size()
+{
+	return static_cast<unsigned>(mGroup.size());
+}
+
+void Any::Array::reserve(unsigned count)
+{
+	mGroup.reserve(count);
+}
+
+void Any::Array::sort()
+{
+	_sort(false, false);
+}
+
+void Any::Array::stable_sort()
+{
+	_sort(true, false);
+}
+
+void Any::Array::parallel_sort()
+{
+	_sort(false, true);
+}
+
+// Equal elements are adjacent once sorted
+void Any::Array::unique()
+{
+	mGroup.erase(std::unique(mGroup.begin(), mGroup.end()), mGroup.end());
+}
+
+bool Any::Array::binary_search(const Any& any)
+{
+	return std::binary_search(mGroup.begin(), mGroup.end(), any);
+}
+
+// Start a new group every time the element differs from the previous one
+Any Any::Array::group_by()
+{
+	Any groups(Type::ARRAY_GROUP);
+	Array run;
+	for (const Any& any : mGroup)
+	{
+		if (run.mGroup.empty() == false && run.mGroup.back() != any)
+		{
+			groups.emplace_back(Any(std::move(run)));
+			run = Array();
+		}
+		run.emplace_back(any);
+	}
+	if (run.mGroup.empty() == false)
+	{
+		groups.emplace_back(Any(std::move(run)));
+	}
+	return groups;
+}
+
 Any::Array::Iterator Any::Array::begin()
 {
 	return mGroup.empty() ? Iterator() : Iterator(&mGroup.front());
@@ -350,3 +582,327 @@ Any::Array::Iterator Any::Array::end()
 {
 	return mGroup.empty() ? Iterator() : ++Iterator(&mGroup.back());
 }
+
+// Moving every element into its type's range keeps the order within each type
+// Each range can then be sorted on its own with a kernel for that type
+void Any::Array::_sort(bool stable, bool parallel)
+{
+	// Below this many elements, starting threads costs more than it saves
+	const size_t parallelThreshold = 1 << 14;
+
+	// Record the types up front, since moved from elements become INVALID_UNSET
+	std::vector<Type> types;
+	types.reserve(mGroup.size());
+	for (const Any& any : mGroup)
+	{
+		types.push_back(Any::_sortType(any.mInternalType));
+	}
+	size_t bounds[(unsigned)Type::COUNT + 1] = {};
+	std::vector<Any> grouped;
+	grouped.reserve(mGroup.size());
+	for (unsigned type = 0; type < (unsigned)Type::COUNT; ++type)
+	{
+		bounds[type] = grouped.size();
+		for (size_t i = 0; i < mGroup.size(); ++i)
+		{
+			if ((unsigned)types[i] == type)
+			{
+				grouped.emplace_back(std::move(mGroup[i]));
+			}
+		}
+	}
+	bounds[(unsigned)Type::COUNT] = grouped.size();
+	mGroup.swap(grouped);
+
+	if (parallel == false || mGroup.size() < parallelThreshold)
+	{
+		for (unsigned type = 0; type < (unsigned)Type::COUNT; ++type)
+		{
+			if (bounds[type + 1] - bounds[type] > 1)
+			{
+				_sortRange(mGroup, bounds[type], bounds[type + 1], (Type)type, stable);
+			}
+		}
+		return;
+	}
+
+	// Split every type's range into chunks, so that even a single type keeps every thread busy
+	unsigned threadCount = std::thread::hardware_concurrency();
+	size_t chunkSize = mGroup.size() / (threadCount > 0 ? threadCount : 1);
+	if (chunkSize < parallelThreshold / 4)
+	{
+		chunkSize = parallelThreshold / 4;
+	}
+	std::vector<size_t> splits[(unsigned)Type::COUNT];
+	std::vector<std::thread> threads;
+	auto joinAll = [&threads]()
+	{
+		for (std::thread& thread : threads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
+		threads.clear();
+	};
+	try
+	{
+		for (unsigned type = 0; type < (unsigned)Type::COUNT; ++type)
+		{
+			for (size_t begin = bounds[type]; begin < bounds[type + 1]; begin += chunkSize)
+			{
+				size_t end = bounds[type + 1] - begin > chunkSize ? begin + chunkSize : bounds[type + 1];
+				splits[type].push_back(begin);
+				try
+				{
+					threads.emplace_back(&Array::_sortRange, std::ref(mGroup), begin, end, (Type)type, stable);
+				}
+				catch (const std::system_error&)
+				{
+					// No thread could be started, so sort the chunk here instead
+					_sortRange(mGroup, begin, end, (Type)type, stable);
+				}
+			}
+			splits[type].push_back(bounds[type + 1]);
+		}
+		joinAll();
+
+		// Merge neighbouring chunks in pairs, each pair on its own thread, until each type is one range
+		bool merging = true;
+		while (merging)
+		{
+			merging = false;
+			for (std::vector<size_t>& points : splits)
+			{
+				if (points.size() <= 2)
+				{
+					continue;
+				}
+				std::vector<size_t> merged(1, points.front());
+				size_t i = 0;
+				for (; i + 2 < points.size(); i += 2)
+				{
+					try
+					{
+						threads.emplace_back(&Array::_mergeRanges, std::ref(mGroup), points[i], points[i + 1], points[i + 2]);
+					}
+					catch (const std::system_error&)
+					{
+						_mergeRanges(mGroup, points[i], points[i + 1], points[i + 2]);
+					}
+					merged.push_back(points[i + 2]);
+				}
+				// An odd chunk out waits for the next round
+				if (i + 1 < points.size())
+				{
+					merged.push_back(points[i + 1]);
+				}
+				points.swap(merged);
+				merging = true;
+			}
+			joinAll();
+		}
+	}
+	catch (...)
+	{
+		// A thread still running when its object is destroyed would terminate the process
+		joinAll();
+		throw;
+	}
+}
+
+// Merging is stable, so stable sorts stay stable across chunks
+void Any::Array::_mergeRanges(std::vector<Any>& group, size_t begin, size_t middle, size_t end)
+{
+	std::inplace_merge(group.begin() + begin, group.begin() + middle, group.begin() + end);
+}
+
+// Numbers and strings are pulled out, sorted as plain values, and written back
+// Equal numbers cannot be told apart, so their sort never needs to be stable
+void Any::Array::_sortRange(std::vector<Any>& group, size_t begin, size_t end, Type type, bool stable)
+{
+	switch (type)
+	{
+	case Type::WHOLE_NUMBER:
+	{
+		std::vector<WHOLE_NUMBER_TYPE> values;
+		values.reserve(end - begin);
+		for (size_t i = begin; i < end; ++i)
+		{
+			values.push_back(group[i].mInternalWholeNumber);
+		}
+		_radixSort(values);
+		for (size_t i = begin; i < end; ++i)
+		{
+			group[i].mInternalWholeNumber = values[i - begin];
+		}
+		break;
+	}
+	case Type::DECIMAL_NUMBER:
+	{
+		// Stable keeps the order of zeros with different signs
+		auto less = [](DECIMAL_NUMBER_TYPE left, DECIMAL_NUMBER_TYPE right)
+		{
+			return std::isnan(right) ? !std::isnan(left) : left < right;
+		};
+		std::vector<DECIMAL_NUMBER_TYPE> values;
+		values.reserve(end - begin);
+		for (size_t i = begin; i < end; ++i)
+		{
+			values.push_back(group[i].mInternalDecimalNumber);
+		}
+		if (stable)
+		{
+			std::stable_sort(values.begin(), values.end(), less);
+		}
+		else
+		{
+			std::sort(values.begin(), values.end(), less);
+		}
+		for (size_t i = begin; i < end; ++i)
+		{
+			group[i].mInternalDecimalNumber = values[i - begin];
+		}
+		break;
+	}
+	case Type::TEXT_STRING:
+	{
+		// The range holds both strings and views, so move the objects themselves into place
+		// The characters are only read while sorting, before anything moves
+		std::vector<TEXT_STRING_VIEW_TYPE> values;
+		values.reserve(end - begin);
+		for (size_t i = begin; i < end; ++i)
+		{
+			values.push_back(group[i]._textContent());
+		}
+		std::vector<size_t> order = _sortTextStrings(values, stable);
+		std::vector<Any> sorted;
+		sorted.reserve(end - begin);
+		for (size_t index : order)
+		{
+			sorted.emplace_back(std::move(group[begin + index]));
+		}
+		for (size_t i = begin; i < end; ++i)
+		{
+			group[i] = std::move(sorted[i - begin]);
+		}
+		break;
+	}
+	case Type::ARRAY_GROUP:
+	{
+		// Moving a group only swaps pointers, so sort the objects directly
+		if (stable)
+		{
+			std::stable_sort(group.begin() + begin, group.begin() + end);
+		}
+		else
+		{
+			std::sort(group.begin() + begin, group.begin() + end);
+		}
+		break;
+	}
+	default:
+		// All invalid objects are equivalent
+		break;
+	}
+}
+
+// Order strings by their first 8 bytes, then by the rest only on ties
+// Most comparisons then only touch a single integer instead of the string memory
+// Returns the index of each string in sorted order
+std::vector<size_t> Any::Array::_sortTextStrings(const std::vector<TEXT_STRING_VIEW_TYPE>& values, bool stable)
+{
+	struct Key
+	{
+		unsigned long long mPrefix;
+		size_t mIndex;
+	};
+	std::vector<Key> keys;
+	keys.reserve(values.size());
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		unsigned long long prefix = 0;
+		for (size_t byte = 0; byte < sizeof(prefix); ++byte)
+		{
+			unsigned char c = byte < values[i].size() ? static_cast<unsigned char>(values[i][byte]) : 0;
+			prefix = (prefix << 8) | c;
+		}
+		keys.push_back(Key{ prefix, i });
+	}
+	auto less = [&values](const Key& left, const Key& right)
+	{
+		if (left.mPrefix != right.mPrefix)
+		{
+			return left.mPrefix < right.mPrefix;
+		}
+		return values[left.mIndex].compare(values[right.mIndex]) < 0;
+	};
+	if (stable)
+	{
+		std::stable_sort(keys.begin(), keys.end(), less);
+	}
+	else
+	{
+		std::sort(keys.begin(), keys.end(), less);
+	}
+	std::vector<size_t> order;
+	order.reserve(keys.size());
+	for (const Key& key : keys)
+	{
+		order.push_back(key.mIndex);
+	}
+	return order;
+}
+
+// Sort by one byte at a time, from least to most significant
+// Flipping the sign bit makes negative numbers order before positive ones as unsigned
+void Any::Array::_radixSort(std::vector<WHOLE_NUMBER_TYPE>& values)
+{
+	// Below this many values, a comparison sort is faster than the counting passes
+	const size_t radixThreshold = 64;
+	if (values.size() < radixThreshold)
+	{
+		std::sort(values.begin(), values.end());
+		return;
+	}
+
+	const unsigned bits = sizeof(WHOLE_NUMBER_TYPE) * 8;
+	const unsigned long long signBit = 1ull << (bits - 1);
+	std::vector<unsigned long long> keys;
+	keys.reserve(values.size());
+	for (WHOLE_NUMBER_TYPE value : values)
+	{
+		keys.push_back(static_cast<unsigned long long>(value) ^ signBit);
+	}
+	std::vector<unsigned long long> buffer(keys.size());
+	for (unsigned shift = 0; shift < bits; shift += 8)
+	{
+		size_t offsets[256] = {};
+		for (unsigned long long key : keys)
+		{
+			++offsets[(key >> shift) & 0xFF];
+		}
+		// Skip the pass when every key has the same byte here
+		if (offsets[(keys.front() >> shift) & 0xFF] == keys.size())
+		{
+			continue;
+		}
+		size_t offset = 0;
+		for (size_t& count : offsets)
+		{
+			size_t start = offset;
+			offset += count;
+			count = start;
+		}
+		for (unsigned long long key : keys)
+		{
+			buffer[offsets[(key >> shift) & 0xFF]++] = key;
+		}
+		keys.swap(buffer);
+	}
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		values[i] = static_cast<WHOLE_NUMBER_TYPE>(keys[i] ^ signBit);
+	}
+}
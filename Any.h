@@ -5,10 +5,12 @@
 // Feel free to replace types with custom ones
 #include <ostream> // Output
 #include <string> // TEXT_STRING_TYPE
+#include <string_view> // TEXT_STRING_VIEW_TYPE
 #include <vector> // Any::Array
 typedef long long int WHOLE_NUMBER_TYPE;
 typedef long double DECIMAL_NUMBER_TYPE;
 typedef std::string TEXT_STRING_TYPE;
+typedef std::string_view TEXT_STRING_VIEW_TYPE;
 typedef void* INVALID_UNSET_TYPE;
 
 class Any
@@ -22,6 +24,7 @@ public:
 		TEXT_STRING,
 		ARRAY_GROUP,
 		INVALID_UNSET,
+		TEXT_STRING_VIEW,
 		COUNT
 	};
 	// The name of the type of value(s) stored in the object
@@ -60,8 +63,12 @@ public:
 			Any* mAny;
 		};
 
-		// Constructor/Destructor
+		// Constructors/Destructor
 		Array();
+		Array(const Array& other);
+		Array& operator=(const Array& other);
+		Array(Array&& other);
+		Array& operator=(Array&& other);
 		~Array();
 
 		// Add an element to the end of the array
@@ -71,11 +78,48 @@ public:
 		// Remove the last element in the array and return a copy
 		Any pop_back();
 
+		// The number of elements in the array
+		unsigned size();
+		// Allocate room for exactly the given number of elements
+		void reserve(unsigned count);
+
+		// Order the elements by type first (in Type order), then by value
+		// Views order together with strings, by their characters
+		// Each type is sorted with a kernel specialized for it
+		void sort();
+		// Same order, but equivalent elements keep their relative positions
+		void stable_sort();
+		// Same order, but large arrays are split into chunks sorted on every hardware thread, then merged
+		void parallel_sort();
+		// Remove all but the first of each run of equal elements
+		// Sort first to remove every duplicate
+		void unique();
+		// Whether a sorted array contains an element equal to the given one
+		bool binary_search(const Any& any);
+		// Split a sorted array into a group of groups of equal elements
+		Any group_by();
+
 		// Managed pointers to the first and one past the last elements in the array
 		Iterator begin();
 		Iterator end();
 
 	private:
+		// Streaming reads the elements without changing their types
+		friend class AnyWriter;
+		// Comparison reads the elements without changing their types
+		friend class Any;
+
+		// Group the elements by type, then sort each type's range
+		void _sort(bool stable, bool parallel);
+		// Sort a range of elements that all have the same type
+		static void _sortRange(std::vector<Any>& group, size_t begin, size_t end, Type type, bool stable);
+		// Merge two neighbouring sorted ranges into one
+		static void _mergeRanges(std::vector<Any>& group, size_t begin, size_t middle, size_t end);
+		// Sort strings by their leading bytes first, returning the index of each in sorted order
+		static std::vector<size_t> _sortTextStrings(const std::vector<TEXT_STRING_VIEW_TYPE>& values, bool stable);
+		// Sort whole numbers by the bytes of their values
+		static void _radixSort(std::vector<WHOLE_NUMBER_TYPE>& values);
+
 		// The actual container data
 		std::vector<Any> mGroup;
 	};
@@ -98,6 +142,8 @@ public:
 	Any(TEXT_STRING_TYPE value);
 	Any(const char* const value);
 	Any(const char* const value, unsigned length);
+	// The referenced characters must outlive the object (or call own)
+	Any(TEXT_STRING_VIEW_TYPE value);
 	Any(Array value);
 
 	// Destruction (releases resources)
@@ -109,8 +155,14 @@ public:
 	friend std::ostream& operator<<(std::ostream& stream, const Property<Any, WHOLE_NUMBER_TYPE>& property);
 	friend std::ostream& operator<<(std::ostream& stream, const Property<Any, DECIMAL_NUMBER_TYPE>& property);
 	friend std::ostream& operator<<(std::ostream& stream, const Property<Any, TEXT_STRING_TYPE>& property);
+	friend std::ostream& operator<<(std::ostream& stream, const Property<Any, TEXT_STRING_VIEW_TYPE>& property);
 	friend std::ostream& operator<<(std::ostream& stream, const Property<Any, Any::Array>& property);
 
+	// Comparison friend functions (orders by type first, then by value)
+	friend bool operator==(const Any& left, const Any& right);
+	friend bool operator!=(const Any& left, const Any& right);
+	friend bool operator<(const Any& left, const Any& right);
+
 	// The public readonly type
 	const Type& mType;
 	// The public readonly type name
@@ -120,6 +172,7 @@ public:
 	Property<Any, WHOLE_NUMBER_TYPE> mWholeNumber;
 	Property<Any, DECIMAL_NUMBER_TYPE> mDecimalNumber;
 	Property<Any, TEXT_STRING_TYPE> mTextString;
+	Property<Any, TEXT_STRING_VIEW_TYPE> mTextStringView;
 	Property<Any, Any::Array> mArrayGroup;
 
 	Array::Iterator emplace_back(const Any& any);
@@ -127,10 +180,23 @@ public:
 
 	Any pop_back();
 
+	// Copy referenced characters into an owned string (TEXT_STRING_VIEW becomes TEXT_STRING)
+	void own();
+
+	void sort();
+	void stable_sort();
+	void parallel_sort();
+	void unique();
+	bool binary_search(const Any& any);
+	Any group_by();
+
 	Array::Iterator begin();
 	Array::Iterator end();
 
 private:
+	// Streaming reads the values without changing their types
+	friend class AnyWriter;
+
 	// The private read/write type
 	Type mInternalType;
 	// The private read/write type name
@@ -140,6 +206,7 @@ private:
 	WHOLE_NUMBER_TYPE& mInternalWholeNumber;
 	DECIMAL_NUMBER_TYPE& mInternalDecimalNumber;
 	TEXT_STRING_TYPE& mInternalTextString;
+	TEXT_STRING_VIEW_TYPE& mInternalTextStringView;
 	Any::Array& mInternalArrayGroup;
 
 	// The actual value
@@ -166,6 +233,7 @@ private:
 		WHOLE_NUMBER_TYPE mWholeNumber;
 		DECIMAL_NUMBER_TYPE mDecimalNumber;
 		TEXT_STRING_TYPE mTextString;
+		TEXT_STRING_VIEW_TYPE mTextStringView;
 		Any::Array mArrayGroup;
 		INVALID_UNSET_TYPE mInvalidUnset;
 	} mData;
@@ -180,6 +248,12 @@ private:
 	void _copyValue(const Any& other);
 	// Swap all contents, including value, type, and typename
 	void _swapContents(Any&& other);
+	// Negative, zero, or positive as left orders before, with, or after right
+	static int _compare(const Any& left, const Any& right);
+	// The type a value orders as (views order as the strings they reference)
+	static Type _sortType(Type type);
+	// The characters of a TEXT_STRING or TEXT_STRING_VIEW
+	TEXT_STRING_VIEW_TYPE _textContent() const;
 
 	// Property get/set methods for automatic type conversions
 	const WHOLE_NUMBER_TYPE& _getWholeNumber()
@@ -204,6 +278,8 @@ private:
 	}
 	const TEXT_STRING_TYPE& _getTextString()
 	{
+		// Keep the referenced characters rather than resetting them
+		own();
 		_setType(Type::TEXT_STRING);
 		return mInternalTextString;
 	}
@@ -212,6 +288,16 @@ private:
 		_setType(Type::TEXT_STRING);
 		mInternalTextString = other;
 	}
+	const TEXT_STRING_VIEW_TYPE& _getTextStringView()
+	{
+		_setType(Type::TEXT_STRING_VIEW);
+		return mInternalTextStringView;
+	}
+	void _setTextStringView(const TEXT_STRING_VIEW_TYPE& other)
+	{
+		_setType(Type::TEXT_STRING_VIEW);
+		mInternalTextStringView = other;
+	}
 	const Any::Array& _getObjectGroup()
 	{
 		_setType(Type::ARRAY_GROUP);
@@ -244,6 +330,9 @@ inline std::ostream& operator<<(std::ostream& stream, const Any& any)
 	case Any::Type::TEXT_STRING:
 		stream << any.mTextString;
 		break;
+	case Any::Type::TEXT_STRING_VIEW:
+		stream << any.mTextStringView;
+		break;
 	case Any::Type::ARRAY_GROUP:
 		stream << any.mArrayGroup;
 		break;
@@ -265,6 +354,10 @@ inline std::ostream& operator<<(std::ostream& stream, const Property<Any, TEXT_S
 {
 	return stream << static_cast<TEXT_STRING_TYPE>(property);
 }
+inline std::ostream& operator<<(std::ostream& stream, const Property<Any, TEXT_STRING_VIEW_TYPE>& property)
+{
+	return stream << static_cast<TEXT_STRING_VIEW_TYPE>(property);
+}
 inline std::ostream& operator<<(std::ostream& stream, const Property<Any, Any::Array>& property)
 {
 	bool first = true;
@@ -0,0 +1,330 @@
+#include "AnyBuilder.h"
+
+#include <cstring> // std::strlen, memcpy
+#include <memory> // std::uninitialized_copy
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyDocument public implementation
+
+AnyDocument::AnyDocument()
+	: mBlockSize(0)
+	, mNodes(nullptr)
+	, mText(nullptr)
+{
+}
+
+AnyDocument::AnyDocument(AnyDocument&& other)
+	: mBlock(std::move(other.mBlock))
+	, mBlockSize(other.mBlockSize)
+	, mNodes(other.mNodes)
+	, mText(other.mText)
+{
+	other.mBlockSize = 0;
+	other.mNodes = nullptr;
+	other.mText = nullptr;
+}
+
+AnyDocument& AnyDocument::operator=(AnyDocument&& other)
+{
+	std::swap(mBlock, other.mBlock);
+	std::swap(mBlockSize, other.mBlockSize);
+	std::swap(mNodes, other.mNodes);
+	std::swap(mText, other.mText);
+	return *this;
+}
+
+// A document without a block reads as a lone, empty top level group
+AnyDocument::Value AnyDocument::root() const
+{
+	static const Node empty = { Any::Type::ARRAY_GROUP, 1, 0, {} };
+	return Value(mNodes != nullptr ? mNodes : &empty, mText, 0);
+}
+
+size_t AnyDocument::memory() const
+{
+	return mBlockSize;
+}
+
+Any AnyDocument::toAny() const
+{
+	return root().toAny();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyDocument::Value implementation
+
+AnyDocument::Value::Value(const Node* nodes, const char* text, unsigned index)
+	: mNodes(nodes)
+	, mText(text)
+	, mIndex(index)
+{
+}
+
+Any::Type AnyDocument::Value::type() const
+{
+	return _node().mType;
+}
+
+const char* AnyDocument::Value::typeName() const
+{
+	return Any::TypeNames[(unsigned)_node().mType];
+}
+
+WHOLE_NUMBER_TYPE AnyDocument::Value::wholeNumber() const
+{
+	return _node().mType == Any::Type::WHOLE_NUMBER ? _node().mWholeNumber : 0;
+}
+
+DECIMAL_NUMBER_TYPE AnyDocument::Value::decimalNumber() const
+{
+	return _node().mType == Any::Type::DECIMAL_NUMBER ? _node().mDecimalNumber : 0;
+}
+
+TEXT_STRING_VIEW_TYPE AnyDocument::Value::textString() const
+{
+	const Node& node = _node();
+	if (node.mType != Any::Type::TEXT_STRING)
+	{
+		return TEXT_STRING_VIEW_TYPE();
+	}
+	return TEXT_STRING_VIEW_TYPE(mText + node.mTextOffset, node.mCount);
+}
+
+unsigned AnyDocument::Value::size() const
+{
+	return _node().mType == Any::Type::ARRAY_GROUP ? _node().mCount : 0;
+}
+
+// A group's first element is the very next node
+AnyDocument::Value::Iterator AnyDocument::Value::begin() const
+{
+	return size() == 0 ? end() : Iterator(mNodes, mText, mIndex + 1);
+}
+
+AnyDocument::Value::Iterator AnyDocument::Value::end() const
+{
+	return Iterator(mNodes, mText, _node().mEnd);
+}
+
+// Every group is reserved at exactly its size
+Any AnyDocument::Value::toAny() const
+{
+	switch (_node().mType)
+	{
+	case Any::Type::WHOLE_NUMBER:
+		return Any(wholeNumber());
+	case Any::Type::DECIMAL_NUMBER:
+		return Any(decimalNumber());
+	case Any::Type::TEXT_STRING:
+	{
+		TEXT_STRING_VIEW_TYPE text = textString();
+		return Any(text.data(), static_cast<unsigned>(text.size()));
+	}
+	case Any::Type::ARRAY_GROUP:
+	{
+		Any::Array group;
+		group.reserve(size());
+		for (Value element : *this)
+		{
+			group.emplace_back(element.toAny());
+		}
+		return Any(std::move(group));
+	}
+	default:
+		return Any();
+	}
+}
+
+const AnyDocument::Node& AnyDocument::Value::_node() const
+{
+	return mNodes[mIndex];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyDocument::Value::Iterator implementation
+
+AnyDocument::Value::Iterator::Iterator()
+	: mNodes(nullptr)
+	, mText(nullptr)
+	, mIndex(0)
+{
+}
+
+AnyDocument::Value::Iterator::Iterator(const Node* nodes, const char* text, unsigned index)
+	: mNodes(nodes)
+	, mText(text)
+	, mIndex(index)
+{
+}
+
+bool AnyDocument::Value::Iterator::operator==(const Iterator& other)
+{
+	return mNodes == other.mNodes && mIndex == other.mIndex;
+}
+
+bool AnyDocument::Value::Iterator::operator!=(const Iterator& other)
+{
+	return !operator==(other);
+}
+
+// The next sibling starts right after the end of this element's nodes
+AnyDocument::Value::Iterator& AnyDocument::Value::Iterator::operator++()
+{
+	mIndex = mNodes[mIndex].mEnd;
+	return *this;
+}
+
+AnyDocument::Value AnyDocument::Value::Iterator::operator*()
+{
+	return Value(mNodes, mText, mIndex);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Output
+
+std::ostream& operator<<(std::ostream& stream, const AnyDocument::Value& value)
+{
+	stream << value.type() << std::string("=");
+	switch (value.type())
+	{
+	case Any::Type::WHOLE_NUMBER:
+		stream << value.wholeNumber();
+		break;
+	case Any::Type::DECIMAL_NUMBER:
+		stream << value.decimalNumber();
+		break;
+	case Any::Type::TEXT_STRING:
+		stream << value.textString();
+		break;
+	case Any::Type::ARRAY_GROUP:
+	{
+		bool first = true;
+		for (AnyDocument::Value element : value)
+		{
+			stream << std::string(first ? "[ " : ", ") << element;
+			first = false;
+		}
+		if (first == false)
+		{
+			stream << std::string(" ]");
+		}
+		break;
+	}
+	default:
+		stream << std::string("N/A");
+		break;
+	}
+	return stream;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyBuilder public implementation
+
+AnyBuilder::AnyBuilder()
+{
+	_reset();
+}
+
+void AnyBuilder::push(WHOLE_NUMBER_TYPE value)
+{
+	_record(Any::Type::WHOLE_NUMBER).mWholeNumber = value;
+}
+
+void AnyBuilder::push(DECIMAL_NUMBER_TYPE value)
+{
+	_record(Any::Type::DECIMAL_NUMBER).mDecimalNumber = value;
+}
+
+void AnyBuilder::push(const TEXT_STRING_TYPE& value)
+{
+	push(TEXT_STRING_VIEW_TYPE(value));
+}
+
+void AnyBuilder::push(const char* const value)
+{
+	push(TEXT_STRING_VIEW_TYPE(value, std::strlen(value)));
+}
+
+// Strings only record where their characters are, the characters go in one shared list
+void AnyBuilder::push(TEXT_STRING_VIEW_TYPE value)
+{
+	Node& node = _record(Any::Type::TEXT_STRING);
+	node.mCount = static_cast<unsigned>(value.size());
+	node.mTextOffset = mText.size();
+	mText.insert(mText.end(), value.begin(), value.end());
+}
+
+void AnyBuilder::pushUnset()
+{
+	_record(Any::Type::INVALID_UNSET);
+}
+
+void AnyBuilder::beginGroup()
+{
+	_record(Any::Type::ARRAY_GROUP);
+	mOpenGroups.push_back(static_cast<unsigned>(mNodes.size() - 1));
+}
+
+// A group ends where the nodes recorded so far end
+void AnyBuilder::endGroup()
+{
+	if (mOpenGroups.size() > 1)
+	{
+		mNodes[mOpenGroups.back()].mEnd = static_cast<unsigned>(mNodes.size());
+		mOpenGroups.pop_back();
+	}
+}
+
+// Copy the nodes and characters into one block of exactly the size they need
+// The recording is released before returning, so only the block remains
+AnyDocument AnyBuilder::freeze()
+{
+	while (mOpenGroups.size() > 1)
+	{
+		endGroup();
+	}
+	mNodes.front().mEnd = static_cast<unsigned>(mNodes.size());
+
+	AnyDocument document;
+	size_t nodeBytes = mNodes.size() * sizeof(Node);
+	document.mBlockSize = nodeBytes + mText.size();
+	document.mBlock.reset(new unsigned char[document.mBlockSize]);
+	Node* nodes = reinterpret_cast<Node*>(document.mBlock.get());
+	std::uninitialized_copy(mNodes.begin(), mNodes.end(), nodes);
+	char* text = reinterpret_cast<char*>(document.mBlock.get() + nodeBytes);
+	if (mText.empty() == false)
+	{
+		memcpy(text, mText.data(), mText.size());
+	}
+	document.mNodes = nodes;
+	document.mText = text;
+
+	_reset();
+	return document;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyBuilder private implementation
+
+AnyBuilder::Node& AnyBuilder::_record(Any::Type type)
+{
+	++mNodes[mOpenGroups.back()].mCount;
+	Node node = {};
+	node.mType = type;
+	node.mEnd = static_cast<unsigned>(mNodes.size() + 1);
+	mNodes.push_back(node);
+	return mNodes.back();
+}
+
+// Swap with empty lists so the memory is actually released
+void AnyBuilder::_reset()
+{
+	std::vector<Node>().swap(mNodes);
+	std::vector<char>().swap(mText);
+	std::vector<unsigned>().swap(mOpenGroups);
+	Node root = {};
+	root.mType = Any::Type::ARRAY_GROUP;
+	root.mEnd = 1;
+	mNodes.push_back(root);
+	mOpenGroups.push_back(0);
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Any.h" // The values being built
+
+#include <cstddef> // size_t
+#include <memory> // AnyDocument block
+#include <ostream> // Output
+#include <vector> // Recorded nodes
+
+// An immutable document stored in a single exactly sized block
+// Every value is a fixed size node, laid out in document order
+// A group's elements directly follow it, so reading a document walks memory front to back
+// The characters of every string follow the nodes in the same block
+class AnyDocument
+{
+private:
+	// The builder lays out the nodes
+	friend class AnyBuilder;
+
+	// A single value in the document
+	struct Node
+	{
+		// The type of the value (strings are always TEXT_STRING)
+		Any::Type mType;
+		// The index one past the last node of this value (the next sibling)
+		unsigned mEnd;
+		// The number of elements of a group, or the number of characters of a string
+		unsigned mCount;
+		// The value itself
+		union
+		{
+			WHOLE_NUMBER_TYPE mWholeNumber;
+			DECIMAL_NUMBER_TYPE mDecimalNumber;
+			// Where the characters of a string start, after the nodes
+			size_t mTextOffset;
+		};
+	};
+
+public:
+	// A read-only handle to a value in the document
+	// Reading never converts the value, other types read as their default value instead
+	class Value
+	{
+	public:
+		// The pointer to the elements of a group
+		class Iterator
+		{
+		public:
+			// Constructors/Destructor
+			Iterator();
+			Iterator(const Node* nodes, const char* text, unsigned index);
+			~Iterator() {}
+
+			// Equivalency operators for iteration
+			bool operator==(const Iterator& other);
+			bool operator!=(const Iterator& other);
+
+			// Preincrement operator for iteration (skips over the whole element)
+			Iterator& operator++();
+
+			// Dereference operator for iteration
+			Value operator*();
+
+		private:
+			// The document's nodes and characters
+			const Node* mNodes;
+			const char* mText;
+			// The element we are pointing to
+			unsigned mIndex;
+		};
+
+		// Constructor/Destructor
+		Value(const Node* nodes, const char* text, unsigned index);
+		~Value() {}
+
+		// The type of the value and its name
+		Any::Type type() const;
+		const char* typeName() const;
+
+		// The value, if it is the matching type
+		WHOLE_NUMBER_TYPE wholeNumber() const;
+		DECIMAL_NUMBER_TYPE decimalNumber() const;
+		// The characters stay valid for as long as the document
+		TEXT_STRING_VIEW_TYPE textString() const;
+
+		// The number of elements in a group
+		unsigned size() const;
+
+		// Pointers to the first and one past the last elements of a group
+		Iterator begin() const;
+		Iterator end() const;
+
+		// Copy the value into a mutable object
+		Any toAny() const;
+
+	private:
+		// The node of the value
+		const Node& _node() const;
+
+		// The document's nodes and characters
+		const Node* mNodes;
+		const char* mText;
+		// The node of the value
+		unsigned mIndex;
+	};
+
+	// Constructors/Destructor (an empty document is an empty top level group)
+	AnyDocument();
+	AnyDocument(AnyDocument&& other);
+	AnyDocument& operator=(AnyDocument&& other);
+	~AnyDocument() {}
+
+	// The top level group
+	Value root() const;
+
+	// The number of bytes in the block
+	size_t memory() const;
+
+	// Copy the document into a mutable object
+	Any toAny() const;
+
+private:
+	// Not copyable, the document is meant to be shared by reference
+	AnyDocument(const AnyDocument& other) = delete;
+	AnyDocument& operator=(const AnyDocument& other) = delete;
+
+	// The single allocation holding the nodes and then the characters
+	std::unique_ptr<unsigned char[]> mBlock;
+	size_t mBlockSize;
+	// Where the nodes and characters are in the block
+	const Node* mNodes;
+	const char* mText;
+};
+
+// Output in the same format as Any
+std::ostream& operator<<(std::ostream& stream, const AnyDocument::Value& value);
+
+// Records a document bottom-up and then freezes it into an AnyDocument
+// Values are recorded into one top level group, like AnyWriter
+class AnyBuilder
+{
+public:
+	// Constructor/Destructor
+	AnyBuilder();
+	~AnyBuilder() {}
+
+	// Record a value in the innermost open group
+	void push(WHOLE_NUMBER_TYPE value);
+	void push(DECIMAL_NUMBER_TYPE value);
+	void push(const TEXT_STRING_TYPE& value);
+	void push(const char* const value);
+	// The characters are copied into the document
+	void push(TEXT_STRING_VIEW_TYPE value);
+	void pushUnset();
+
+	// Open a nested group
+	void beginGroup();
+	// Close the innermost nested group (the top level group is left open)
+	void endGroup();
+
+	// Close all open groups and copy everything into one exactly sized block
+	// The builder is left empty and can be reused
+	AnyDocument freeze();
+
+private:
+	typedef AnyDocument::Node Node;
+
+	// Record a node and count it towards the innermost open group
+	Node& _record(Any::Type type);
+	// Start over with just an open top level group
+	void _reset();
+
+	// Every node in document order, starting with the top level group
+	std::vector<Node> mNodes;
+	// The characters of every string
+	std::vector<char> mText;
+	// The node indices of the currently open groups
+	std::vector<unsigned> mOpenGroups;
+};
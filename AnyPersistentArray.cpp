@@ -0,0 +1,223 @@
+#include "AnyPersistentArray.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Public implementation
+
+AnyPersistentArray::AnyPersistentArray()
+	: mShift(0)
+	, mSize(0)
+{
+}
+
+// Only the root is copied, every node is shared
+AnyPersistentArray::AnyPersistentArray(const AnyPersistentArray& other)
+	: mRoot(other.mRoot)
+	, mShift(other.mShift)
+	, mSize(other.mSize)
+{
+}
+
+AnyPersistentArray& AnyPersistentArray::operator=(const AnyPersistentArray& other)
+{
+	mRoot = other.mRoot;
+	mShift = other.mShift;
+	mSize = other.mSize;
+	return *this;
+}
+
+AnyPersistentArray::AnyPersistentArray(Any& group)
+	: AnyPersistentArray()
+{
+	if (group.mType == Any::Type::ARRAY_GROUP)
+	{
+		for (auto&& any : group)
+		{
+			emplace_back(any);
+		}
+	}
+}
+
+void AnyPersistentArray::emplace_back(const Any& any)
+{
+	_pushBack(std::make_shared<const Any>(any));
+}
+
+void AnyPersistentArray::emplace_back(Any&& any)
+{
+	_pushBack(std::make_shared<const Any>(std::move(any)));
+}
+
+// Collapse the root whenever it is left with a single branch
+Any AnyPersistentArray::pop_back()
+{
+	Any back = at(mSize - 1);
+	if (mSize == 1)
+	{
+		mRoot = nullptr;
+		mShift = 0;
+	}
+	else
+	{
+		mRoot = _pop(mRoot.get(), mShift, mSize - 1);
+		if (mShift > 0 && mRoot->mChildren.size() == 1)
+		{
+			mRoot = mRoot->mChildren.front();
+			mShift -= BITS;
+		}
+	}
+	--mSize;
+	return back;
+}
+
+void AnyPersistentArray::set(unsigned index, const Any& any)
+{
+	_set(index, std::make_shared<const Any>(any));
+}
+
+void AnyPersistentArray::set(unsigned index, Any&& any)
+{
+	_set(index, std::make_shared<const Any>(std::move(any)));
+}
+
+// Each level uses the next BITS bits of the index, from the top down
+Any AnyPersistentArray::at(unsigned index)
+{
+	const Node* node = mRoot.get();
+	for (unsigned shift = mShift; shift > 0; shift -= BITS)
+	{
+		node = node->mChildren[(index >> shift) & MASK].get();
+	}
+	return *node->mValues[index & MASK];
+}
+
+unsigned AnyPersistentArray::size()
+{
+	return mSize;
+}
+
+Any AnyPersistentArray::toAny()
+{
+	Any::Array group;
+	group.reserve(mSize);
+	if (mRoot)
+	{
+		_collect(mRoot.get(), group);
+	}
+	return Any(std::move(group));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Private implementation
+
+// Grow the tree by one level when every slot below the root is taken
+void AnyPersistentArray::_pushBack(ValuePointer value)
+{
+	if (mRoot == nullptr)
+	{
+		mRoot = _path(0, value);
+	}
+	else if (static_cast<unsigned long long>(mSize) == (1ull << (mShift + BITS)))
+	{
+		std::shared_ptr<Node> root = std::make_shared<Node>();
+		root->mChildren.push_back(mRoot);
+		root->mChildren.push_back(_path(mShift, value));
+		mRoot = root;
+		mShift += BITS;
+	}
+	else
+	{
+		mRoot = _push(mRoot.get(), mShift, mSize, value);
+	}
+	++mSize;
+}
+
+void AnyPersistentArray::_set(unsigned index, ValuePointer value)
+{
+	mRoot = _set(mRoot.get(), mShift, index, value);
+}
+
+AnyPersistentArray::NodePointer AnyPersistentArray::_path(unsigned shift, ValuePointer value)
+{
+	std::shared_ptr<Node> node = std::make_shared<Node>();
+	if (shift == 0)
+	{
+		node->mValues.push_back(value);
+	}
+	else
+	{
+		node->mChildren.push_back(_path(shift - BITS, value));
+	}
+	return node;
+}
+
+// Copying a node only copies its pointers, never the elements themselves
+AnyPersistentArray::NodePointer AnyPersistentArray::_push(const Node* node, unsigned shift, unsigned index, ValuePointer value)
+{
+	std::shared_ptr<Node> copy = std::make_shared<Node>(*node);
+	if (shift == 0)
+	{
+		copy->mValues.push_back(value);
+	}
+	else
+	{
+		unsigned branch = (index >> shift) & MASK;
+		if (branch < copy->mChildren.size())
+		{
+			copy->mChildren[branch] = _push(node->mChildren[branch].get(), shift - BITS, index, value);
+		}
+		else
+		{
+			copy->mChildren.push_back(_path(shift - BITS, value));
+		}
+	}
+	return copy;
+}
+
+AnyPersistentArray::NodePointer AnyPersistentArray::_set(const Node* node, unsigned shift, unsigned index, ValuePointer value)
+{
+	std::shared_ptr<Node> copy = std::make_shared<Node>(*node);
+	if (shift == 0)
+	{
+		copy->mValues[index & MASK] = value;
+	}
+	else
+	{
+		unsigned branch = (index >> shift) & MASK;
+		copy->mChildren[branch] = _set(node->mChildren[branch].get(), shift - BITS, index, value);
+	}
+	return copy;
+}
+
+// The last element is always on the last branch of every level
+AnyPersistentArray::NodePointer AnyPersistentArray::_pop(const Node* node, unsigned shift, unsigned index)
+{
+	std::shared_ptr<Node> copy = std::make_shared<Node>(*node);
+	if (shift == 0)
+	{
+		copy->mValues.pop_back();
+		return copy->mValues.empty() ? nullptr : copy;
+	}
+	unsigned branch = (index >> shift) & MASK;
+	NodePointer child = _pop(node->mChildren[branch].get(), shift - BITS, index);
+	if (child == nullptr)
+	{
+		copy->mChildren.pop_back();
+	}
+	else
+	{
+		copy->mChildren[branch] = child;
+	}
+	return copy->mChildren.empty() ? nullptr : copy;
+}
+
+void AnyPersistentArray::_collect(const Node* node, Any::Array& group)
+{
+	for (auto&& child : node->mChildren)
+	{
+		_collect(child.get(), group);
+	}
+	for (auto&& value : node->mValues)
+	{
+		group.emplace_back(*value);
+	}
+}
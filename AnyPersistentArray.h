@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Any.h" // The values being stored
+
+#include <memory> // Shared nodes
+#include <vector> // Node contents
+
+// A group where copies are cheap and share everything they have not changed
+// Elements are kept in a tree with up to 32 branches per node
+// Changing a version only copies the nodes on the path to the changed element
+// That makes every change O(log n) in time and memory, and leaves other versions untouched
+class AnyPersistentArray
+{
+public:
+	// Constructors/Destructor
+	AnyPersistentArray();
+	AnyPersistentArray(const AnyPersistentArray& other);
+	AnyPersistentArray& operator=(const AnyPersistentArray& other);
+	// Copy the elements of a group (any other type results in no elements)
+	AnyPersistentArray(Any& group);
+	~AnyPersistentArray() {}
+
+	// Add an element to the end of this version
+	void emplace_back(const Any& any);
+	void emplace_back(Any&& any);
+
+	// Remove the last element of this version and return a copy
+	Any pop_back();
+
+	// Replace an element of this version
+	void set(unsigned index, const Any& any);
+	void set(unsigned index, Any&& any);
+
+	// Copy an element
+	// Elements are shared between versions, so they are never handed out by reference
+	Any at(unsigned index);
+
+	// The number of elements in this version
+	unsigned size();
+
+	// Copy the elements of this version into a plain group
+	Any toAny();
+
+private:
+	// The number of bits of the index handled by each level of the tree
+	static const unsigned BITS = 5;
+	// The number of branches or elements in a full node
+	static const unsigned WIDTH = 1u << BITS;
+	// The bits of the index handled by a single level
+	static const unsigned MASK = WIDTH - 1;
+
+	// A node is never changed once it can be shared
+	struct Node;
+	typedef std::shared_ptr<const Node> NodePointer;
+	typedef std::shared_ptr<const Any> ValuePointer;
+	struct Node
+	{
+		// The child nodes (only used above the bottom level)
+		std::vector<NodePointer> mChildren;
+		// The elements (only used at the bottom level)
+		std::vector<ValuePointer> mValues;
+	};
+
+	// Add an element to the end
+	void _pushBack(ValuePointer value);
+	// Replace an element
+	void _set(unsigned index, ValuePointer value);
+
+	// Build a new path down to a single element
+	static NodePointer _path(unsigned shift, ValuePointer value);
+	// Copy the path to the end and add an element there
+	static NodePointer _push(const Node* node, unsigned shift, unsigned index, ValuePointer value);
+	// Copy the path to an element and replace it
+	static NodePointer _set(const Node* node, unsigned shift, unsigned index, ValuePointer value);
+	// Copy the path to the last element and remove it (returns null if nothing is left)
+	static NodePointer _pop(const Node* node, unsigned shift, unsigned index);
+	// Copy every element below a node into a group in order
+	static void _collect(const Node* node, Any::Array& group);
+
+	// The top of the tree (null when there are no elements)
+	NodePointer mRoot;
+	// How far to shift an index to find the branch taken at the root
+	unsigned mShift;
+	// The number of elements
+	unsigned mSize;
+};
@@ -0,0 +1,491 @@
+#include "AnyStream.h"
+
+#include <cmath> // std::frexp, std::ldexp
+#include <limits> // Infinity and not-a-number
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyWriter public implementation
+
+// Reserve the whole buffer up front so pushing never reallocates
+// The top level group is opened immediately so elements can follow
+AnyWriter::AnyWriter(Sink sink, size_t bufferSize)
+	: mSink(sink)
+	, mBufferSize(bufferSize > 0 ? bufferSize : 1)
+	, mDepth(0)
+	, mFinished(false)
+{
+	mBuffer.reserve(mBufferSize);
+	_writeTag(StreamTag::ARRAY_GROUP);
+}
+
+// Forward full buffers straight on to the output stream
+AnyWriter::AnyWriter(std::ostream& stream, size_t bufferSize)
+	: AnyWriter([&stream](const char* data, size_t size)
+		{
+			stream.write(data, static_cast<std::streamsize>(size));
+		}, bufferSize)
+{
+}
+
+void AnyWriter::push(const Any& any)
+{
+	if (mFinished == false)
+	{
+		_writeValue(any);
+	}
+}
+
+void AnyWriter::beginGroup()
+{
+	if (mFinished == false)
+	{
+		_writeTag(StreamTag::ARRAY_GROUP);
+		++mDepth;
+	}
+}
+
+void AnyWriter::endGroup()
+{
+	if (mFinished == false && mDepth > 0)
+	{
+		_writeTag(StreamTag::GROUP_END);
+		--mDepth;
+	}
+}
+
+// Close every nested group and then the top level group
+void AnyWriter::finish()
+{
+	if (mFinished == false)
+	{
+		while (mDepth > 0)
+		{
+			endGroup();
+		}
+		_writeTag(StreamTag::GROUP_END);
+		_flush();
+		mFinished = true;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyWriter private implementation
+
+// Read the internal values directly so writing never changes the type
+void AnyWriter::_writeValue(const Any& any)
+{
+	switch (any.mInternalType)
+	{
+	case Any::Type::WHOLE_NUMBER:
+		_writeTag(StreamTag::WHOLE_NUMBER);
+		_writeUnsigned(static_cast<unsigned long long>(any.mInternalWholeNumber), 8);
+		break;
+	case Any::Type::DECIMAL_NUMBER:
+	{
+		// Split into a 64 bit mantissa and an exponent, which is exact for up to 64 bits of precision
+		DECIMAL_NUMBER_TYPE value = any.mInternalDecimalNumber;
+		DecimalKind kind = std::signbit(value) ? DecimalKind::NEGATIVE : DecimalKind::POSITIVE;
+		int exponent = 0;
+		unsigned long long mantissa = 0;
+		if (std::isnan(value))
+		{
+			kind = DecimalKind::NOT_A_NUMBER;
+		}
+		else if (std::isinf(value))
+		{
+			kind = value < 0 ? DecimalKind::NEGATIVE_INFINITY : DecimalKind::POSITIVE_INFINITY;
+		}
+		else
+		{
+			DECIMAL_NUMBER_TYPE fraction = std::frexp(std::fabs(value), &exponent);
+			mantissa = static_cast<unsigned long long>(std::ldexp(fraction, 64));
+		}
+		_writeTag(StreamTag::DECIMAL_NUMBER);
+		_writeUnsigned(static_cast<unsigned long long>(kind), 1);
+		_writeUnsigned(static_cast<unsigned long long>(exponent), 2);
+		_writeUnsigned(mantissa, 8);
+		break;
+	}
+	case Any::Type::TEXT_STRING:
+	{
+		size_t length = any.mInternalTextString.size();
+		_writeTag(StreamTag::TEXT_STRING);
+		_writeUnsigned(static_cast<unsigned long long>(length), 8);
+		_writeBytes(any.mInternalTextString.data(), length);
+		break;
+	}
+	case Any::Type::TEXT_STRING_VIEW:
+	{
+		// Referenced characters are written out as an owned string
+		size_t length = any.mInternalTextStringView.size();
+		_writeTag(StreamTag::TEXT_STRING);
+		_writeUnsigned(static_cast<unsigned long long>(length), 8);
+		_writeBytes(any.mInternalTextStringView.data(), length);
+		break;
+	}
+	case Any::Type::ARRAY_GROUP:
+		_writeTag(StreamTag::ARRAY_GROUP);
+		for (const Any& element : any.mInternalArrayGroup.mGroup)
+		{
+			_writeValue(element);
+		}
+		_writeTag(StreamTag::GROUP_END);
+		break;
+	default:
+		_writeTag(StreamTag::INVALID_UNSET);
+		break;
+	}
+}
+
+void AnyWriter::_writeTag(StreamTag tag)
+{
+	_writeUnsigned(static_cast<unsigned long long>(tag), 1);
+}
+
+void AnyWriter::_writeUnsigned(unsigned long long value, unsigned size)
+{
+	unsigned char bytes[8];
+	for (unsigned i = 0; i < size; ++i)
+	{
+		bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+	}
+	_writeBytes(bytes, size);
+}
+
+// Fill the buffer piece by piece so that large strings stay bounded too
+void AnyWriter::_writeBytes(const void* data, size_t size)
+{
+	const char* bytes = static_cast<const char*>(data);
+	while (size > 0)
+	{
+		size_t space = mBufferSize - mBuffer.size();
+		size_t count = size < space ? size : space;
+		mBuffer.insert(mBuffer.end(), bytes, bytes + count);
+		bytes += count;
+		size -= count;
+		if (mBuffer.size() == mBufferSize)
+		{
+			_flush();
+		}
+	}
+}
+
+void AnyWriter::_flush()
+{
+	if (mBuffer.empty() == false)
+	{
+		mSink(mBuffer.data(), mBuffer.size());
+		mBuffer.clear();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyReader public implementation
+
+AnyReader::AnyReader(std::istream& stream)
+	: mStream(stream)
+	, mStarted(false)
+	, mDone(false)
+	, mDepth(0)
+	, mTag(0)
+	, mHasTag(false)
+	, mFailed(false)
+{
+}
+
+// Only a GROUP_END tag is a clean end, anything else that stops reading is a failure
+bool AnyReader::next(Any& any)
+{
+	unsigned char tag;
+	if (_start() == false)
+	{
+		return false;
+	}
+	if (_peekTag(tag) == false)
+	{
+		return _fail();
+	}
+	mHasTag = false;
+	if (tag == static_cast<unsigned char>(StreamTag::GROUP_END))
+	{
+		if (mDepth > 0)
+		{
+			--mDepth;
+		}
+		else
+		{
+			mDone = true;
+		}
+		return false;
+	}
+	if (_readValue(any, tag, mDepth) == false)
+	{
+		return _fail();
+	}
+	return true;
+}
+
+// Leave the tag for next to read if the element is not a group
+bool AnyReader::beginGroup()
+{
+	unsigned char tag;
+	if (_start() == false)
+	{
+		return false;
+	}
+	if (_peekTag(tag) == false)
+	{
+		return _fail();
+	}
+	if (tag != static_cast<unsigned char>(StreamTag::ARRAY_GROUP))
+	{
+		return false;
+	}
+	if (mDepth + 1 >= MAX_DEPTH)
+	{
+		return _fail();
+	}
+	mHasTag = false;
+	++mDepth;
+	return true;
+}
+
+bool AnyReader::failed()
+{
+	return mFailed;
+}
+
+AnyReader::Iterator AnyReader::begin()
+{
+	return Iterator(this);
+}
+
+AnyReader::Iterator AnyReader::end()
+{
+	return Iterator();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyReader private implementation
+
+// Check the top level group tag lazily so construction never blocks on input
+bool AnyReader::_start()
+{
+	if (mDone || mFailed)
+	{
+		return false;
+	}
+	if (mStarted == false)
+	{
+		unsigned char tag;
+		mStarted = true;
+		if (_readTag(tag) == false || tag != static_cast<unsigned char>(StreamTag::ARRAY_GROUP))
+		{
+			return _fail();
+		}
+	}
+	return true;
+}
+
+bool AnyReader::_peekTag(unsigned char& tag)
+{
+	if (mHasTag == false)
+	{
+		if (_readTag(mTag) == false)
+		{
+			return false;
+		}
+		mHasTag = true;
+	}
+	tag = mTag;
+	return true;
+}
+
+// Groups reached here are read whole, use beginGroup to stream them instead
+bool AnyReader::_readValue(Any& any, unsigned char tag, unsigned depth)
+{
+	switch (static_cast<StreamTag>(tag))
+	{
+	case StreamTag::WHOLE_NUMBER:
+	{
+		unsigned long long value;
+		if (_readUnsigned(value, 8) == false)
+		{
+			return false;
+		}
+		any = Any(static_cast<WHOLE_NUMBER_TYPE>(value));
+		return true;
+	}
+	case StreamTag::DECIMAL_NUMBER:
+	{
+		unsigned long long kind;
+		unsigned long long exponent;
+		unsigned long long mantissa;
+		if (_readUnsigned(kind, 1) == false || _readUnsigned(exponent, 2) == false
+			|| _readUnsigned(mantissa, 8) == false)
+		{
+			return false;
+		}
+		DECIMAL_NUMBER_TYPE value;
+		switch (static_cast<DecimalKind>(kind))
+		{
+		case DecimalKind::POSITIVE:
+		case DecimalKind::NEGATIVE:
+			// The exponent is a 2 byte two's complement number
+			value = std::ldexp(static_cast<DECIMAL_NUMBER_TYPE>(mantissa),
+				static_cast<int>(static_cast<short>(static_cast<unsigned short>(exponent))) - 64);
+			if (static_cast<DecimalKind>(kind) == DecimalKind::NEGATIVE)
+			{
+				value = -value;
+			}
+			break;
+		case DecimalKind::POSITIVE_INFINITY:
+			value = std::numeric_limits<DECIMAL_NUMBER_TYPE>::infinity();
+			break;
+		case DecimalKind::NEGATIVE_INFINITY:
+			value = -std::numeric_limits<DECIMAL_NUMBER_TYPE>::infinity();
+			break;
+		case DecimalKind::NOT_A_NUMBER:
+			value = std::numeric_limits<DECIMAL_NUMBER_TYPE>::quiet_NaN();
+			break;
+		default:
+			return false;
+		}
+		any = Any(value);
+		return true;
+	}
+	case StreamTag::TEXT_STRING:
+	{
+		unsigned long long length;
+		if (_readUnsigned(length, 8) == false)
+		{
+			return false;
+		}
+		TEXT_STRING_TYPE value;
+		if (length > value.max_size())
+		{
+			return false;
+		}
+		// Only grow the string as its characters actually arrive
+		while (value.size() < length)
+		{
+			size_t read = value.size();
+			size_t count = length - read < STRING_CHUNK ? length - read : STRING_CHUNK;
+			value.resize(read + count);
+			if (_readBytes(&value[read], count) == false)
+			{
+				return false;
+			}
+		}
+		any = Any(std::move(value));
+		return true;
+	}
+	case StreamTag::ARRAY_GROUP:
+	{
+		if (depth >= MAX_DEPTH)
+		{
+			return false;
+		}
+		Any group(Any::Type::ARRAY_GROUP);
+		unsigned char elementTag;
+		while (_readTag(elementTag))
+		{
+			if (elementTag == static_cast<unsigned char>(StreamTag::GROUP_END))
+			{
+				any = std::move(group);
+				return true;
+			}
+			Any element;
+			if (_readValue(element, elementTag, depth + 1) == false)
+			{
+				return false;
+			}
+			group.emplace_back(std::move(element));
+		}
+		return false;
+	}
+	case StreamTag::INVALID_UNSET:
+		any = Any();
+		return true;
+	default:
+		// Unknown tags mean the input is malformed
+		return false;
+	}
+}
+
+bool AnyReader::_readTag(unsigned char& tag)
+{
+	return _readBytes(&tag, sizeof(tag));
+}
+
+bool AnyReader::_readUnsigned(unsigned long long& value, unsigned size)
+{
+	unsigned char bytes[8];
+	if (_readBytes(bytes, size) == false)
+	{
+		return false;
+	}
+	value = 0;
+	for (unsigned i = 0; i < size; ++i)
+	{
+		value |= static_cast<unsigned long long>(bytes[i]) << (8 * i);
+	}
+	return true;
+}
+
+bool AnyReader::_readBytes(void* data, size_t size)
+{
+	mStream.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+	return static_cast<size_t>(mStream.gcount()) == size;
+}
+
+bool AnyReader::_fail()
+{
+	mFailed = true;
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyReader::Iterator implementation
+
+AnyReader::Iterator::Iterator()
+	: mReader(nullptr)
+{
+}
+
+// Read the first element right away so dereferencing begin is valid
+AnyReader::Iterator::Iterator(AnyReader* reader)
+	: mReader(reader)
+{
+	operator++();
+}
+
+bool AnyReader::Iterator::operator==(const Iterator& other)
+{
+	return mReader == other.mReader;
+}
+
+bool AnyReader::Iterator::operator!=(const Iterator& other)
+{
+	return !operator==(other);
+}
+
+// Become the end iterator once the reader runs out of elements
+AnyReader::Iterator& AnyReader::Iterator::operator++()
+{
+	if (mReader != nullptr && mReader->next(mCurrent) == false)
+	{
+		mReader = nullptr;
+	}
+	return *this;
+}
+
+Any& AnyReader::Iterator::operator*()
+{
+	return mCurrent;
+}
+
+Any* AnyReader::Iterator::operator->()
+{
+	return &mCurrent;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "Any.h" // The values being streamed
+
+#include <cstddef> // size_t
+#include <functional> // AnyWriter::Sink
+#include <istream> // Input
+#include <ostream> // Output
+#include <vector> // AnyWriter buffer
+
+// The streamed layout is one top level group, written element by element
+// Every value starts with a single byte StreamTag
+// Every multi-byte number is little-endian, so streams read the same on every compiler
+// The tags are fixed here rather than taken from Any::Type, so streams stay readable as types are added
+// WHOLE_NUMBER is followed by 8 bytes of two's complement value
+// DECIMAL_NUMBER is followed by 11 bytes: a kind (see DecimalKind),
+// a 2 byte signed exponent, and an 8 byte mantissa scaled to 64 bits
+// TEXT_STRING is followed by an 8 byte length and then the characters
+// TEXT_STRING_VIEW is written as a TEXT_STRING
+// ARRAY_GROUP is followed by its elements and then a GROUP_END tag
+// INVALID_UNSET has no payload
+
+// The tag in front of every streamed value
+enum class StreamTag : unsigned char
+{
+	WHOLE_NUMBER = 0,
+	DECIMAL_NUMBER = 1,
+	TEXT_STRING = 2,
+	ARRAY_GROUP = 3,
+	INVALID_UNSET = 4,
+	GROUP_END = 5
+};
+
+// The kinds of DECIMAL_NUMBER, so that signs, infinities and not-a-number survive
+enum class DecimalKind : unsigned char
+{
+	POSITIVE,
+	NEGATIVE,
+	POSITIVE_INFINITY,
+	NEGATIVE_INFINITY,
+	NOT_A_NUMBER
+};
+
+// Serializes elements to a sink as they are pushed, using bounded memory
+class AnyWriter
+{
+public:
+	// Receives a full buffer of bytes
+	// The writer waits on the sink, so a slow sink applies backpressure
+	typedef std::function<void(const char* data, size_t size)> Sink;
+
+	// Constructors/Destructor
+	AnyWriter(Sink sink, size_t bufferSize = 4096);
+	AnyWriter(std::ostream& stream, size_t bufferSize = 4096);
+	// Never closes the stream, so a writer abandoned partway (e.g. by an exception) leaves it unterminated
+	~AnyWriter() {}
+
+	// Write an element into the innermost open group
+	void push(const Any& any);
+
+	// Open a nested group so its elements can be pushed one at a time
+	void beginGroup();
+	// Close the innermost nested group (the top level group is left open)
+	void endGroup();
+
+	// Close all open groups and hand any remaining bytes to the sink
+	// Must be called explicitly, only a finished stream reads back as complete
+	void finish();
+
+private:
+	// Not copyable, the sink and buffer are not shareable
+	AnyWriter(const AnyWriter& other) = delete;
+	AnyWriter& operator=(const AnyWriter& other) = delete;
+
+	// Recursively write a tagged value
+	void _writeValue(const Any& any);
+	// Write a single type tag
+	void _writeTag(StreamTag tag);
+	// Write the lowest size bytes of a number, least significant first
+	void _writeUnsigned(unsigned long long value, unsigned size);
+	// Copy bytes into the buffer, handing it to the sink whenever it fills
+	void _writeBytes(const void* data, size_t size);
+	// Hand the buffered bytes to the sink
+	void _flush();
+
+	// Where the bytes go
+	Sink mSink;
+	// The pending bytes (never grows beyond mBufferSize)
+	std::vector<char> mBuffer;
+	size_t mBufferSize;
+	// The number of nested groups opened with beginGroup
+	unsigned mDepth;
+	// Whether finish has already closed the stream
+	bool mFinished;
+};
+
+// Reads the elements of a stream written by AnyWriter one at a time
+// Any group, not only the top level one, can be stepped into with beginGroup
+// and its elements read one at a time, so a huge nested group never has to fit in memory
+class AnyReader
+{
+public:
+	// The input iterator over the remaining elements of the current group
+	// Reaching the end does not mean the stream was complete, check failed afterwards
+	class Iterator
+	{
+	public:
+		// Constructors/Destructor
+		Iterator();
+		Iterator(AnyReader* reader);
+		~Iterator() {}
+
+		// Equivalency operators for iteration
+		bool operator==(const Iterator& other);
+		bool operator!=(const Iterator& other);
+
+		// Preincrement operator for iteration (reads the next element)
+		Iterator& operator++();
+
+		// Dereference and member access operators for iteration
+		Any& operator*();
+		Any* operator->();
+
+	private:
+		// The reader we pull from (null once the stream is exhausted)
+		AnyReader* mReader;
+		// The element most recently read
+		Any mCurrent;
+	};
+
+	// Constructor/Destructor
+	AnyReader(std::istream& stream);
+	~AnyReader() {}
+
+	// Read the next element of the current group whole
+	// Returns false once the group ends or the input is malformed
+	// Callers must check failed afterwards, a truncated stream otherwise looks like a clean end
+	// Once a group stepped into with beginGroup ends, reading continues with its parent
+	bool next(Any& any);
+
+	// Step into the next element instead of reading it whole, if it is a group
+	// Returns false (reading nothing) if the next element is not a group
+	bool beginGroup();
+
+	// Whether reading stopped on truncated or malformed input rather than the end of the group
+	bool failed();
+
+	// Only a single pass is possible, so begin always continues from here
+	Iterator begin();
+	Iterator end();
+
+private:
+	// The deepest nesting of groups accepted, so malformed input cannot exhaust the stack
+	static const unsigned MAX_DEPTH = 256;
+	// Strings are read this many bytes at a time, so a bad length cannot allocate ahead of the input
+	static const unsigned STRING_CHUNK = 4096;
+
+	// Not copyable, the stream position is not shareable
+	AnyReader(const AnyReader& other) = delete;
+	AnyReader& operator=(const AnyReader& other) = delete;
+
+	// Read the top level group tag the first time through
+	// Returns false once reading has ended or failed
+	bool _start();
+	// Read the next tag, unless one was already read ahead by beginGroup
+	bool _peekTag(unsigned char& tag);
+	// Recursively read the value for a tag that was already read
+	bool _readValue(Any& any, unsigned char tag, unsigned depth);
+	// Read a single type tag
+	bool _readTag(unsigned char& tag);
+	// Read a number of size bytes, least significant first
+	bool _readUnsigned(unsigned long long& value, unsigned size);
+	// Read exactly the requested number of bytes
+	bool _readBytes(void* data, size_t size);
+	// Stop reading because the input is truncated or malformed (always returns false)
+	bool _fail();
+
+	// Where the bytes come from
+	std::istream& mStream;
+	// Whether the top level group tag has been read
+	bool mStarted;
+	// Whether the top level group has ended
+	bool mDone;
+	// The number of groups stepped into below the top level
+	unsigned mDepth;
+	// A tag read ahead by beginGroup that belongs to the next element
+	unsigned char mTag;
+	bool mHasTag;
+	// Whether the input turned out to be truncated or malformed
+	bool mFailed;
+};
@@ -0,0 +1,265 @@
+#include "AnyTable.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Public implementation
+
+AnyTable::AnyTable()
+	: mSize(0)
+{
+}
+
+// The first record sets the shape, every other record must match it
+bool AnyTable::detectShape(Any& group, Shape& shape)
+{
+	shape.clear();
+	if (group.mType != Any::Type::ARRAY_GROUP)
+	{
+		return false;
+	}
+	bool first = true;
+	for (auto&& record : group)
+	{
+		if (record.mType != Any::Type::ARRAY_GROUP)
+		{
+			return false;
+		}
+		unsigned position = 0;
+		for (auto&& element : record)
+		{
+			if (first)
+			{
+				shape.push_back(element.mType);
+			}
+			else if (position >= shape.size() || shape[position] != element.mType)
+			{
+				return false;
+			}
+			++position;
+		}
+		if (position != shape.size())
+		{
+			return false;
+		}
+		first = false;
+	}
+	return first == false;
+}
+
+// Detect the shape first so that nothing is stored for mismatched records
+bool AnyTable::assign(Any& group)
+{
+	Shape shape;
+	mShape.clear();
+	mColumns.clear();
+	mSize = 0;
+	if (detectShape(group, shape) == false)
+	{
+		return false;
+	}
+	mShape = shape;
+	mColumns.resize(mShape.size());
+	for (auto&& record : group)
+	{
+		_append(record);
+	}
+	return true;
+}
+
+bool AnyTable::emplace_back(Any& record)
+{
+	if (mSize == 0 && mShape.empty())
+	{
+		if (record.mType != Any::Type::ARRAY_GROUP)
+		{
+			return false;
+		}
+		for (auto&& element : record)
+		{
+			mShape.push_back(element.mType);
+		}
+		mColumns.resize(mShape.size());
+	}
+	else if (_matches(record) == false)
+	{
+		return false;
+	}
+	_append(record);
+	return true;
+}
+
+unsigned AnyTable::size()
+{
+	return mSize;
+}
+
+const AnyTable::Shape& AnyTable::shape()
+{
+	return mShape;
+}
+
+// Gather the value at the row from every column
+Any AnyTable::row(unsigned index)
+{
+	Any::Array record;
+	record.reserve(static_cast<unsigned>(mShape.size()));
+	for (unsigned column = 0; column < mShape.size(); ++column)
+	{
+		switch (mShape[column])
+		{
+		case Any::Type::WHOLE_NUMBER:
+			record.emplace_back(Any(mColumns[column].mWholeNumbers[index]));
+			break;
+		case Any::Type::DECIMAL_NUMBER:
+			record.emplace_back(Any(mColumns[column].mDecimalNumbers[index]));
+			break;
+		case Any::Type::TEXT_STRING:
+			record.emplace_back(Any(mColumns[column].mTextStrings[index]));
+			break;
+		case Any::Type::TEXT_STRING_VIEW:
+			record.emplace_back(Any(mColumns[column].mTextStringViews[index]));
+			break;
+		case Any::Type::ARRAY_GROUP:
+			record.emplace_back(mColumns[column].mArrayGroups[index]);
+			break;
+		default:
+			record.emplace_back(Any());
+			break;
+		}
+	}
+	return Any(std::move(record));
+}
+
+Any AnyTable::toAny()
+{
+	Any::Array group;
+	group.reserve(mSize);
+	for (unsigned index = 0; index < mSize; ++index)
+	{
+		group.emplace_back(row(index));
+	}
+	return Any(std::move(group));
+}
+
+AnyTable::Iterator AnyTable::begin()
+{
+	return mSize == 0 ? Iterator() : Iterator(this, 0);
+}
+
+AnyTable::Iterator AnyTable::end()
+{
+	return mSize == 0 ? Iterator() : Iterator(this, mSize);
+}
+
+const std::vector<WHOLE_NUMBER_TYPE>& AnyTable::wholeNumbers(unsigned column)
+{
+	return mColumns[column].mWholeNumbers;
+}
+
+const std::vector<DECIMAL_NUMBER_TYPE>& AnyTable::decimalNumbers(unsigned column)
+{
+	return mColumns[column].mDecimalNumbers;
+}
+
+const std::vector<TEXT_STRING_TYPE>& AnyTable::textStrings(unsigned column)
+{
+	return mColumns[column].mTextStrings;
+}
+
+const std::vector<TEXT_STRING_VIEW_TYPE>& AnyTable::textStringViews(unsigned column)
+{
+	return mColumns[column].mTextStringViews;
+}
+
+const std::vector<Any>& AnyTable::arrayGroups(unsigned column)
+{
+	return mColumns[column].mArrayGroups;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Private implementation
+
+bool AnyTable::_matches(Any& record)
+{
+	if (record.mType != Any::Type::ARRAY_GROUP)
+	{
+		return false;
+	}
+	unsigned position = 0;
+	for (auto&& element : record)
+	{
+		if (position >= mShape.size() || mShape[position] != element.mType)
+		{
+			return false;
+		}
+		++position;
+	}
+	return position == mShape.size();
+}
+
+// The types already match, so reading the values never converts them
+void AnyTable::_append(Any& record)
+{
+	unsigned column = 0;
+	for (auto&& element : record)
+	{
+		switch (mShape[column])
+		{
+		case Any::Type::WHOLE_NUMBER:
+			mColumns[column].mWholeNumbers.push_back(element.mWholeNumber);
+			break;
+		case Any::Type::DECIMAL_NUMBER:
+			mColumns[column].mDecimalNumbers.push_back(element.mDecimalNumber);
+			break;
+		case Any::Type::TEXT_STRING:
+			mColumns[column].mTextStrings.push_back(element.mTextString);
+			break;
+		case Any::Type::TEXT_STRING_VIEW:
+			mColumns[column].mTextStringViews.push_back(element.mTextStringView);
+			break;
+		case Any::Type::ARRAY_GROUP:
+			mColumns[column].mArrayGroups.push_back(element);
+			break;
+		default:
+			// Nothing to store for invalid values
+			break;
+		}
+		++column;
+	}
+	++mSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AnyTable::Iterator implementation
+
+AnyTable::Iterator::Iterator()
+	: mTable(nullptr)
+	, mIndex(0)
+{
+}
+
+AnyTable::Iterator::Iterator(AnyTable* table, unsigned index)
+	: mTable(table)
+	, mIndex(index)
+{
+}
+
+bool AnyTable::Iterator::operator==(const Iterator& other)
+{
+	return mTable == other.mTable && mIndex == other.mIndex;
+}
+
+bool AnyTable::Iterator::operator!=(const Iterator& other)
+{
+	return !operator==(other);
+}
+
+AnyTable::Iterator& AnyTable::Iterator::operator++()
+{
+	++mIndex;
+	return *this;
+}
+
+Any AnyTable::Iterator::operator*()
+{
+	return mTable->row(mIndex);
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Any.h" // The records being stored
+
+#include <vector> // Columns
+
+// Stores a group of same-shaped records as one typed column per position
+// A record is a group whose elements have the same types in the same positions
+// Rows share no per-record allocations, and column scans touch only one column
+class AnyTable
+{
+public:
+	// The shape of a record: the type of the element at each position
+	typedef std::vector<Any::Type> Shape;
+
+	// The input iterator over the rows, each rebuilt as a group on access
+	// Rows are returned by value, since changing one would not change the columns
+	// Rebuilding a row allocates its group, only the column scans avoid that
+	class Iterator
+	{
+	public:
+		// Constructors/Destructor
+		Iterator();
+		Iterator(AnyTable* table, unsigned index);
+		~Iterator() {}
+
+		// Equivalency operators for iteration
+		bool operator==(const Iterator& other);
+		bool operator!=(const Iterator& other);
+
+		// Preincrement operator for iteration
+		Iterator& operator++();
+
+		// Dereference operator for iteration (rebuilds the row on every call)
+		Any operator*();
+
+	private:
+		// The table and row we are pointing to
+		AnyTable* mTable;
+		unsigned mIndex;
+	};
+
+	// Constructor/Destructor
+	AnyTable();
+	~AnyTable() {}
+
+	// Find the shape shared by every record in the group
+	// Returns false if the group is empty, not a group, or the shapes differ
+	static bool detectShape(Any& group, Shape& shape);
+
+	// Replace the contents with the records of the group
+	// Returns false (leaving the table empty) if the records are not same-shaped
+	bool assign(Any& group);
+	// Add a record to the end of the table
+	// The first record sets the shape, returns false if the shape differs
+	bool emplace_back(Any& record);
+
+	// The number of rows
+	unsigned size();
+	// The type of the element at each position of every row
+	const Shape& shape();
+
+	// Rebuild a single row as a newly allocated group
+	Any row(unsigned index);
+	// Rebuild the whole table as a group of groups
+	Any toAny();
+
+	// Managed pointers to the first and one past the last rows
+	Iterator begin();
+	Iterator end();
+
+	// Direct access to a column for scans
+	// Only the list matching the column's type in the shape holds values
+	const std::vector<WHOLE_NUMBER_TYPE>& wholeNumbers(unsigned column);
+	const std::vector<DECIMAL_NUMBER_TYPE>& decimalNumbers(unsigned column);
+	const std::vector<TEXT_STRING_TYPE>& textStrings(unsigned column);
+	const std::vector<TEXT_STRING_VIEW_TYPE>& textStringViews(unsigned column);
+	const std::vector<Any>& arrayGroups(unsigned column);
+
+private:
+	// The values at one position of every row
+	struct Column
+	{
+		std::vector<WHOLE_NUMBER_TYPE> mWholeNumbers;
+		std::vector<DECIMAL_NUMBER_TYPE> mDecimalNumbers;
+		std::vector<TEXT_STRING_TYPE> mTextStrings;
+		std::vector<TEXT_STRING_VIEW_TYPE> mTextStringViews;
+		// Nested groups are not split any further
+		std::vector<Any> mArrayGroups;
+	};
+
+	// Check that a record matches the shape
+	bool _matches(Any& record);
+	// Append the values of a record that matches the shape
+	void _append(Any& record);
+
+	// The type of the element at each position of every row
+	Shape mShape;
+	// One column per position
+	std::vector<Column> mColumns;
+	// The number of rows
+	unsigned mSize;
+};
@@ -1,6 +1,11 @@
 #include "Any.h"
+#include "AnyBuilder.h"
+#include "AnyPersistentArray.h"
+#include "AnyStream.h"
+#include "AnyTable.h"
 
 #include <iostream>
+#include <sstream>
 
 int main(void)
 {
@@ -71,6 +76,143 @@ int main(void)
 		std::cout << std::endl;
 	}
 
+	// Test string view usage
+	{
+		const char* buffer = "token1 token2";
+		Any view(TEXT_STRING_VIEW_TYPE(buffer, 6));
+		std::cout << "view[" << view << "]" << std::endl;
+		Any copy = view;
+		copy.own();
+		std::cout << "copy[" << copy << "]" << std::endl;
+		view.mTextStringView = TEXT_STRING_VIEW_TYPE(buffer + 7, 6);
+		std::cout << "view.mTextStringView[" << view.mTextStringView << "]" << std::endl;
+		std::cout << "view.mTextString[" << view.mTextString << "]" << std::endl;
+		std::cout << "view.mType[" << view.mType << "]" << std::endl;
+		std::cout << std::endl;
+	}
+
+	// Test builder usage
+	{
+		AnyBuilder builder;
+		builder.push((WHOLE_NUMBER_TYPE)1);
+		builder.beginGroup();
+		builder.push((DECIMAL_NUMBER_TYPE)2.5);
+		builder.push("Built 3");
+		builder.endGroup();
+		builder.pushUnset();
+		AnyDocument frozen = builder.freeze();
+		std::cout << "frozen[" << frozen.root() << "]" << std::endl;
+		std::cout << "frozen.root().size()[" << frozen.root().size() << "]" << std::endl;
+		std::cout << std::endl;
+	}
+
+	// Test table usage
+	{
+		Any records;
+		for (WHOLE_NUMBER_TYPE i = 0; i < 3; ++i)
+		{
+			Any record;
+			record.emplace_back(Any(i));
+			record.emplace_back(Any((DECIMAL_NUMBER_TYPE)i / 2));
+			records.emplace_back(std::move(record));
+		}
+		AnyTable table;
+		std::cout << "table.assign[" << table.assign(records) << "]" << std::endl;
+		for (auto&& value : table.decimalNumbers(1))
+		{
+			std::cout << "column[" << value << "]" << std::endl;
+		}
+		for (auto&& row : table)
+		{
+			std::cout << "row[" << row << "]" << std::endl;
+		}
+		for (auto&& row : table)
+		{
+			for (auto&& value : row)
+			{
+				std::cout << "value[" << value << "]" << std::endl;
+			}
+		}
+		std::cout << std::endl;
+	}
+
+	// Test persistent array usage
+	{
+		AnyPersistentArray original;
+		for (WHOLE_NUMBER_TYPE i = 0; i < 4; ++i)
+		{
+			original.emplace_back(Any(i));
+		}
+		AnyPersistentArray edited = original;
+		edited.set(1, Any((DECIMAL_NUMBER_TYPE)1.5));
+		edited.pop_back();
+		edited.emplace_back(Any("Edited"));
+		std::cout << "original[" << original.toAny() << "]" << std::endl;
+		std::cout << "edited[" << edited.toAny() << "]" << std::endl;
+		std::cout << std::endl;
+	}
+
+	// Test sorting usage
+	{
+		Any group;
+		group.emplace_back(Any((WHOLE_NUMBER_TYPE)3));
+		group.emplace_back(Any((DECIMAL_NUMBER_TYPE)0.5));
+		group.emplace_back(Any((WHOLE_NUMBER_TYPE)-7));
+		group.emplace_back(Any());
+		group.emplace_back(Any((WHOLE_NUMBER_TYPE)3));
+		group.emplace_back(Any((DECIMAL_NUMBER_TYPE)-2.25));
+		group.sort();
+		std::cout << "sorted[" << group << "]" << std::endl;
+		std::cout << "group.binary_search[" << group.binary_search(Any((WHOLE_NUMBER_TYPE)-7)) << "]" << std::endl;
+		std::cout << "group.group_by[" << group.group_by() << "]" << std::endl;
+		group.unique();
+		std::cout << "unique[" << group << "]" << std::endl;
+		std::cout << std::endl;
+	}
+
+	// Test streaming usage
+	{
+		std::stringstream stream;
+		{
+			AnyWriter writer(stream, 16);
+			writer.push(Any((WHOLE_NUMBER_TYPE)1));
+			writer.push(Any((DECIMAL_NUMBER_TYPE)2.5));
+			writer.beginGroup();
+			writer.push(Any((WHOLE_NUMBER_TYPE)3));
+			writer.push(Any((WHOLE_NUMBER_TYPE)4));
+			writer.endGroup();
+			writer.push(Any());
+			writer.finish();
+		}
+		AnyReader reader(stream);
+		for (auto&& any : reader)
+		{
+			std::cout << "streamed[" << any << "]" << std::endl;
+		}
+		std::cout << "reader.failed[" << reader.failed() << "]" << std::endl;
+
+		// Step into the nested group instead of reading it whole
+		stream.clear();
+		stream.seekg(0);
+		AnyReader stepper(stream);
+		Any any;
+		while (stepper.beginGroup() == false && stepper.next(any))
+		{
+			std::cout << "before[" << any << "]" << std::endl;
+		}
+		while (stepper.next(any))
+		{
+			std::cout << "nested[" << any << "]" << std::endl;
+		}
+		// The nested group has ended, so reading continues with the top level
+		while (stepper.next(any))
+		{
+			std::cout << "after[" << any << "]" << std::endl;
+		}
+		std::cout << "stepper.failed[" << stepper.failed() << "]" << std::endl;
+		std::cout << std::endl;
+	}
+
 	char waitForChar;
 	std::cin >> waitForChar;
 	return 0;